@@ -1,5 +1,7 @@
 #include "SDRAM.h"
 #include "smalloc.h"
+#include "sdram_timing.h"
+#include <errno.h>
 
 extern uint8_t external_psram_size;
 void* extmem_base;
@@ -12,12 +14,32 @@ uint32_t semc_clk __attribute((weak)) = SEMC_CLOCK_166;
 struct smalloc_pool extmem_smalloc_pool;
 #endif
 
+// default = no newlib heap or framebuffer region, everything goes to extmem_smalloc_pool
+#ifndef SDRAM_HEAP_SIZE
+#define SDRAM_HEAP_SIZE 0
+#endif
+#ifndef SDRAM_FB_SIZE
+#define SDRAM_FB_SIZE 0
+#endif
+size_t sdram_heap_size __attribute((weak)) = SDRAM_HEAP_SIZE;
+size_t sdram_fb_size __attribute((weak)) = SDRAM_FB_SIZE;
+
+sdram_region sdram_heap_region;
+sdram_region sdram_pool_region;
+sdram_region sdram_fb_region;
+bool sdram_split_ok;
+
+// RAM2 heap, used by sdram_sbrk() when there is no SDRAM heap region
+extern char _heap_start[], _heap_end[];
+static sdram_region ram2_heap_region;
+
+// mirrors smalloc's internal block header (struct smalloc_hdr: rsz, usz, tag)
+#define SM_HEADER_SZ (3 * sizeof(uintptr_t))
+
 // default base address
 #define SDRAM_BASE 0x80000000
 // default SDRAM size (in MBs)
 #define SDRAM_SIZE 32
-// CAS latency 3 will be used if frequency is above this, else use CL=2
-#define SDRAM_CAS2_MAX 1665e5f
 
 #define PROBE_DATA 0x5A698421
 
@@ -333,16 +355,16 @@ FLASHMEM void startup_middle_hook(void)
 		SEMC_SDRAMCR0_BL(3)  | // 3 = 8 word burst length
 		SEMC_SDRAMCR0_PS;      // 16-bit words
 	SEMC_SDRAMCR1 = \
-		SEMC_SDRAMCR1_ACT2PRE((ns_to_clocks(42, freq)-1)) | // tRAS: ACTIVE to PRECHARGE
-		SEMC_SDRAMCR1_CKEOFF((ns_to_clocks(42, freq)-1)) |  // self refresh
-		SEMC_SDRAMCR1_WRC((ns_to_clocks(12, freq)-1)) |     // tWR: WRITE recovery
-		SEMC_SDRAMCR1_RFRC((ns_to_clocks(60, freq)-1)) |    // tRFC or tXSR: REFRESH recovery
-		SEMC_SDRAMCR1_ACT2RW((ns_to_clocks(18, freq)-1)) |  // tRCD: ACTIVE to READ/WRITE
-		SEMC_SDRAMCR1_PRE2ACT((ns_to_clocks(18, freq)-1));  // tRP: PRECHARGE to ACTIVE/REFRESH
+		SEMC_SDRAMCR1_ACT2PRE((ns_to_clocks(SDRAM_TRAS_NS, freq)-1)) | // tRAS: ACTIVE to PRECHARGE
+		SEMC_SDRAMCR1_CKEOFF((ns_to_clocks(SDRAM_TRAS_NS, freq)-1)) |  // self refresh
+		SEMC_SDRAMCR1_WRC((ns_to_clocks(SDRAM_TWR_NS, freq)-1)) |      // tWR: WRITE recovery
+		SEMC_SDRAMCR1_RFRC((ns_to_clocks(SDRAM_TRFC_NS, freq)-1)) |    // tRFC or tXSR: REFRESH recovery
+		SEMC_SDRAMCR1_ACT2RW((ns_to_clocks(SDRAM_TRCD_NS, freq)-1)) |  // tRCD: ACTIVE to READ/WRITE
+		SEMC_SDRAMCR1_PRE2ACT((ns_to_clocks(SDRAM_TRP_NS, freq)-1));   // tRP: PRECHARGE to ACTIVE/REFRESH
 	SEMC_SDRAMCR2 =
-		SEMC_SDRAMCR2_SRRC((ns_to_clocks(66, freq)-1)) |
-		SEMC_SDRAMCR2_REF2REF(ns_to_clocks(60, freq)-1) |
-		SEMC_SDRAMCR2_ACT2ACT(ns_to_clocks(60, freq)-1) |
+		SEMC_SDRAMCR2_SRRC((ns_to_clocks(SDRAM_TXSR_NS, freq)-1)) |
+		SEMC_SDRAMCR2_REF2REF(ns_to_clocks(SDRAM_TRFC_NS, freq)-1) |
+		SEMC_SDRAMCR2_ACT2ACT(ns_to_clocks(SDRAM_TRC_NS, freq)-1) |
 		SEMC_SDRAMCR2_ITO(0);
 
 	uint32_t prescaleperiod = 160 * (1000000000 / freq);
@@ -354,7 +376,7 @@ FLASHMEM void startup_middle_hook(void)
 		while (1);
 	}
 
-	uint16_t refresh = (64 * 1000000 / 8192) / prescaleperiod;
+	uint16_t refresh = (SDRAM_REFRESH_MS * 1000000 / SDRAM_REFRESH_COUNT) / prescaleperiod;
 	uint16_t urgentRef = refresh;
 	//uint16_t idle = 0 / prescaleperiod
 
@@ -394,14 +416,75 @@ FLASHMEM void startup_middle_hook(void)
 	external_psram_size = SDRAM_SIZE;
 	extmem_size = SDRAM_SIZE;
 
+	// split SDRAM between newlib heap, smalloc pool and framebuffers (invalid sizes = all pool)
+	sdram_split_ok = sdram_region_split(extmem_base, SDRAM_SIZE * (1<<20), sdram_heap_size, sdram_fb_size,
+		&sdram_heap_region, &sdram_pool_region, &sdram_fb_region);
+
 	// initialize pool for SDRAM
-	sm_set_pool(&extmem_smalloc_pool, extmem_base, SDRAM_SIZE * (1<<20), 0, NULL);
+	sm_set_pool(&extmem_smalloc_pool, sdram_pool_region.base, sdram_pool_region.size, 0, NULL);
+}
+
+void *sdram_sbrk(int incr)
+{
+	sdram_region *heap = &sdram_heap_region;
+
+	// no SDRAM or no heap region: keep malloc working from RAM2
+	if (heap->size == 0)
+	{
+		if (ram2_heap_region.base == NULL)
+			sdram_region_init(&ram2_heap_region, _heap_start, _heap_end - _heap_start);
+		heap = &ram2_heap_region;
+	}
+
+	void *prev = sdram_region_sbrk(heap, incr);
+	if (prev == NULL)
+	{
+		errno = ENOMEM;
+		return (void*)-1;
+	}
+	return prev;
+}
+
+void *sdram_fb_alloc(size_t size)
+{
+	return sdram_region_alloc(&sdram_fb_region, size, SDRAM_REGION_ALIGN);
+}
+
+// pool space taken by an allocation: header plus the size rounded up the way smalloc does
+static size_t pool_block_size(void *ptr)
+{
+	size_t size = sm_szalloc_pool(&extmem_smalloc_pool, ptr);
+	return SM_HEADER_SZ + (size + SM_HEADER_SZ - 1) / SM_HEADER_SZ * SM_HEADER_SZ;
+}
+
+static void pool_account(ptrdiff_t delta)
+{
+	// pool isn't ours if SDRAM wasn't detected (e.g. PSRAM is present)
+	if (sdram_pool_region.size != 0)
+		sdram_region_account(&sdram_pool_region, delta);
+}
+
+size_t sdram_pool_stats(void)
+{
+	size_t total = 0, user = 0, free_bytes = 0;
+	int nr_blocks = 0;
+
+	if (sdram_pool_region.size == 0)
+		return 0;
+	// the return value isn't a success flag when nothing is allocated, go by nr_blocks instead
+	sm_malloc_stats_pool(&extmem_smalloc_pool, &total, &user, &free_bytes, &nr_blocks);
+	sdram_region_set_used(&sdram_pool_region, nr_blocks > 0 ? total - free_bytes : 0);
+	return sdram_pool_region.used;
 }
 
 void *extmem_malloc(size_t size)
 {
 	void *ptr = sm_malloc_pool(&extmem_smalloc_pool, size);
-	if (ptr) return ptr;
+	if (ptr)
+	{
+		pool_account(pool_block_size(ptr));
+		return ptr;
+	}
 	return malloc(size);
 }
 
@@ -409,6 +492,7 @@ void extmem_free(void *ptr)
 {
 	if (sm_alloc_valid_pool(&extmem_smalloc_pool, ptr))
 	{
+		pool_account(-(ptrdiff_t)pool_block_size(ptr));
 		sm_free_pool(&extmem_smalloc_pool, ptr);
 		return;
 	}
@@ -418,7 +502,11 @@ void extmem_free(void *ptr)
 void *extmem_calloc(size_t nmemb, size_t size)
 {
 	void *ptr = sm_calloc_pool(&extmem_smalloc_pool, nmemb, size);
-	if (ptr) return ptr;
+	if (ptr)
+	{
+		pool_account(pool_block_size(ptr));
+		return ptr;
+	}
 	return calloc(nmemb, size);
 }
 
@@ -426,7 +514,14 @@ void *extmem_realloc(void *ptr, size_t size)
 {
 	if (sm_alloc_valid_pool(&extmem_smalloc_pool, ptr))
 	{
-		return sm_realloc_pool(&extmem_smalloc_pool, ptr, size);
+		size_t old_size = pool_block_size(ptr);
+		void *new_ptr = sm_realloc_pool(&extmem_smalloc_pool, ptr, size);
+		if (new_ptr)
+			pool_account((ptrdiff_t)pool_block_size(new_ptr) - (ptrdiff_t)old_size);
+		// size 0 frees the block, any other failure leaves it untouched
+		else if (size == 0)
+			pool_account(-(ptrdiff_t)old_size);
+		return new_ptr;
 	}
 	return realloc(ptr, size);
 }
@@ -2,6 +2,7 @@
 #define _SDRAM_H_
 
 #include "Arduino.h"
+#include "sdram_region.h"
 
 #define SEMC_CLOCK_133  (CCM_CBCDR_SEMC_CLK_SEL | CCM_CBCDR_SEMC_ALT_CLK_SEL | CCM_CBCDR_SEMC_PODF(4))
 #define SEMC_CLOCK_166  (CCM_CBCDR_SEMC_CLK_SEL | CCM_CBCDR_SEMC_ALT_CLK_SEL | CCM_CBCDR_SEMC_PODF(3))
@@ -21,6 +22,37 @@ extern float extmem_freq();
 // this is a weak symbol, can be overridden to one of the speeds above
 extern uint32_t semc_clk;
 
+/* SDRAM split between the newlib heap, extmem_smalloc_pool and a framebuffer region.
+ * Sizes are in bytes; the pool gets whatever is left. Set them at build time with
+ * -DSDRAM_HEAP_SIZE=... / -DSDRAM_FB_SIZE=... or override these weak symbols.
+ * See examples/sdram_heap_split.
+ */
+extern size_t sdram_heap_size;
+extern size_t sdram_fb_size;
+/* false if SDRAM wasn't detected, or if sdram_heap_size + sdram_fb_size didn't fit;
+ * in that case all of SDRAM goes to the pool and the heap/framebuffer regions are empty
+ */
+extern bool sdram_split_ok;
+// usage and high-water stats for each region (all zero if SDRAM isn't present)
+extern sdram_region sdram_heap_region;
+extern sdram_region sdram_pool_region;
+extern sdram_region sdram_fb_region;
+/* sdram_pool_region is kept up to date by the extmem_* functions. This walks the whole
+ * pool to get the exact figure (including sm_*_pool calls made directly on
+ * extmem_smalloc_pool), updates sdram_pool_region and returns the bytes in use.
+ */
+extern size_t sdram_pool_stats(void);
+
+/* _sbrk replacement backed by sdram_heap_region. To move the newlib heap into SDRAM
+ * define this in the sketch (and make sdram_heap_size non-zero):
+ *   extern "C" void* _sbrk(int incr) { return sdram_sbrk(incr); }
+ * If the heap region is empty (no SDRAM, sdram_heap_size == 0 or sdram_split_ok is
+ * false) it falls back to the normal RAM2 heap. Fails with ENOMEM once the region is full.
+ */
+extern void* sdram_sbrk(int incr);
+// allocate from the framebuffer region (64-byte aligned), never freed
+extern void* sdram_fb_alloc(size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,9 @@
 #include <errno.h>
 
 // override default _sbrk to use SDRAM as heap
+// This claims all 32MB and doesn't use the SDRAM library. Sketches that also use
+// the library's extmem_smalloc_pool should set sdram_heap_size and forward _sbrk
+// to sdram_sbrk() instead, otherwise the two heaps overlap (see examples/sdram_heap_split).
 
 static const unsigned long _heap_start = 0x80000000;
 static const unsigned long _heap_end = 0x82000000;
@@ -58,6 +58,8 @@ uint32_t semc_clk = SEMC_CLOCK_CPU_DIV_3;
 // defined using max dimensions due to laziness
 // LCDIF framebuffers must be 64-byte aligned
 typedef uint8_t framebuffer_t[1920*1080] __attribute__((aligned(64)));
+// reserve space for the framebuffer at the top of SDRAM (weak symbol in SDRAM.c)
+size_t sdram_fb_size = sizeof(framebuffer_t);
 static uint8_t *s_frameBuffer;
 
 static volatile bool s_frameDone = false;
@@ -250,7 +252,11 @@ static void FillFrameBuffer(uint8_t *fb) {
 void setup() {
   Serial.begin(0);
 
-  s_frameBuffer = (uint8_t*)extmem_base;
+  s_frameBuffer = (uint8_t*)sdram_fb_alloc(sizeof(framebuffer_t));
+  if (s_frameBuffer == NULL) {
+    Serial.println("Failed to allocate framebuffer");
+    while(1);
+  }
 
   set_vid_clk(4*timing.clk_num,timing.clk_den);
   init_lcd(&timing);
@@ -1,34 +1,6 @@
 #include <SDRAM.h>
 
-typedef struct {
-  uint32_t height;
-  uint32_t vfp; // vertical front porch
-  uint32_t vsw; // vertical sync width
-  uint32_t vbp; // vertical back porch
-  uint32_t width;
-  uint32_t hfp; // horizontal front porch
-  uint32_t hsw; // horizontal sync width
-  uint32_t hbp; // horizontal back porch
-  // clk_num * 24MHz / clk_den = pixel clock
-  uint32_t clk_num; // pix_clk numerator
-  uint32_t clk_den; // pix_clk denominator
-  uint32_t vpolarity; // 0 (active low vsync/negative) or LCDIF_VDCTRL0_VSYNC_POL (active high/positive)
-  uint32_t hpolarity; // 0 (active low hsync/negative) or LCDIF_VDCTRL0_HSYNC_POL (active high/positive)
-} vga_timing;
-
-const vga_timing t1920x1080x60 = {1080, 4, 5, 36, 1920, 88, 44, 148, 297, 48, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
-// as above but with half clock speed
-const vga_timing t1920x1080x30 = {1080, 4, 5, 36, 1920, 88, 44, 148, 297, 96, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
-const vga_timing t1680x1050x60 = {1050, 1, 3, 33, 1680, 104, 184, 288, 6125, 999, LCDIF_VDCTRL0_VSYNC_POL, 0};
-const vga_timing t1280x1024x60 = {1024, 1, 3, 38, 1280, 48, 112, 248, 108, 24, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
-const vga_timing t1280x720x60 = {720, 13, 5, 12, 1280, 80, 40, 248, 7425, 2400, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
-const vga_timing t1024x768x60 = {768, 3, 6, 29, 1024, 24, 136, 160, 65, 24, 0, 0};
-
-const vga_timing t800x600x100 =  {600, 1, 3, 32, 800, 48, 88, 136, 6818, 2400, LCDIF_VDCTRL0_VSYNC_POL, 0};
-const vga_timing t800x600x60 =   {600, 1, 4, 23, 800, 40, 128, 88, 40, 24, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
-const vga_timing t640x480x60 =   {480, 10, 2, 33, 640, 16, 96, 48, 150, 143, 0, 0};
-const vga_timing t640x400x70 =   {400, 12, 2, 35, 640, 16, 96, 48, 150, 143, LCDIF_VDCTRL0_VSYNC_POL, 0};
-const vga_timing t640x350x70 =   {350, 37, 2, 60, 640, 16, 96, 48, 150, 143, 0, LCDIF_VDCTRL0_HSYNC_POL};
+#include "vga_bandwidth.h"
 
 // select desired mode here
 #define timing t1920x1080x60
@@ -58,16 +30,30 @@ uint32_t semc_clk = SEMC_CLOCK_CPU_DIV_3;
 // defined using max dimensions due to laziness
 // LCDIF framebuffers must be 64-byte aligned
 typedef uint8_t framebuffer_t[1920*1080] __attribute__((aligned(64)));
+// reserve space for both framebuffers at the top of SDRAM (weak symbol in SDRAM.c)
+size_t sdram_fb_size = 2*sizeof(framebuffer_t);
 static uint8_t* s_frameBuffer[2];
 
 static volatile bool s_frameDone = false;
 
+// LCDIF error counters, reported and reset once per second from loop()
+static volatile uint32_t s_frames;
+static volatile uint32_t s_underflows;
+static volatile uint32_t s_bmErrors;
+// frames that ended before loop() had queued the next buffer (previous frame gets repeated)
+static volatile uint32_t s_lateFrames;
+
 static void LCDIF_ISR(void) {
   uint32_t intStatus = LCDIF_CTRL1 & (LCDIF_CTRL1_BM_ERROR_IRQ | LCDIF_CTRL1_OVERFLOW_IRQ | LCDIF_CTRL1_UNDERFLOW_IRQ | LCDIF_CTRL1_CUR_FRAME_DONE_IRQ | LCDIF_CTRL1_VSYNC_EDGE_IRQ);
   // clear all pending LCD interrupts
   LCDIF_CTRL1_CLR = intStatus;
 
+  if (intStatus & LCDIF_CTRL1_UNDERFLOW_IRQ) s_underflows++;
+  if (intStatus & LCDIF_CTRL1_BM_ERROR_IRQ) s_bmErrors++;
+
   if (intStatus & (LCDIF_CTRL1_CUR_FRAME_DONE_IRQ | LCDIF_CTRL1_VSYNC_EDGE_IRQ)) {
+    s_frames++;
+    if (s_frameDone) s_lateFrames++;
     s_frameDone = true;
   }
 
@@ -278,11 +264,34 @@ static void FillFrameBuffer(uint8_t *fb) {
   yoff += ydir;
 }
 
+FLASHMEM static void print_bandwidth(const vga_timing* vid, unsigned int bpp) {
+  vga_bandwidth bw;
+  if (!vga_bandwidth_plan(vid, bpp, extmem_freq(), 0, &bw)) {
+    Serial.println("Bandwidth: unable to plan (no SDRAM or invalid timing)");
+    return;
+  }
+  // FillFrameBuffer() rewrites a whole framebuffer every frame, so the CPU needs as much as scanout does
+  vga_bandwidth_plan(vid, bpp, extmem_freq(), bw.scanout_avg, &bw);
+  Serial.printf("Mode: %ux%u @ %.2fHz, pix_clk %.2fMHz\n", vid->width, vid->height, bw.refresh, bw.pix_clk / 1e6f);
+  Serial.printf("SEMC: %.1fMB/s (%.1fMB/s usable), scanout: %.1fMB/s peak, %.1fMB/s avg (%.0f%% load)\n",
+    bw.semc_peak / 1e6f, bw.semc_usable / 1e6f, bw.scanout_peak / 1e6f, bw.scanout_avg / 1e6f, bw.load * 100.0f);
+  Serial.printf("CPU headroom: %.1fMB/s, redraw needs %.1fMB/s\n", bw.cpu_headroom / 1e6f, bw.scanout_avg / 1e6f);
+  if (!bw.fits)
+    Serial.println("WARNING: scanout + CPU traffic exceeds usable SEMC bandwidth, expect underflows");
+}
+
 void setup() {
   Serial.begin(0);
 
-  s_frameBuffer[0] = (uint8_t*)extmem_base;
-  s_frameBuffer[1] = (uint8_t*)extmem_base + sizeof(framebuffer_t);
+  // 8 bits per pixel (LUT)
+  print_bandwidth(&timing, 1);
+
+  s_frameBuffer[0] = (uint8_t*)sdram_fb_alloc(sizeof(framebuffer_t));
+  s_frameBuffer[1] = (uint8_t*)sdram_fb_alloc(sizeof(framebuffer_t));
+  if (s_frameBuffer[0] == NULL || s_frameBuffer[1] == NULL) {
+    Serial.println("Failed to allocate framebuffers");
+    while(1);
+  }
 
   set_vid_clk(4*timing.clk_num,timing.clk_den);
   init_lcd(&timing);
@@ -303,6 +312,8 @@ void setup() {
   Serial.println("Unmasking frame interrupt");
   // unmask CUR_FRAME_DONE interrupt
   LCDIF_CTRL1_SET = LCDIF_CTRL1_CUR_FRAME_DONE_IRQ_EN;
+  // also count underflows and bus master errors
+  LCDIF_CTRL1_SET = LCDIF_CTRL1_UNDERFLOW_IRQ_EN | LCDIF_CTRL1_BM_ERROR_IRQ_EN;
   // VSYNC_EDGE interrupt also available to notify beginning of raster
   //LCDIF_CTRL1_SET = LCDIF_CTRL1_VSYNC_EDGE_IRQ_EN;
   Serial.println("Running LCD");
@@ -321,4 +332,14 @@ void loop() {
     LCDIF_NEXT_BUF = (uint32_t)s_frameBuffer[nextBufferIndex];
     s_frameDone = false;
   }
+
+  static elapsedMillis msec;
+  if (msec >= 1000) {
+    msec -= 1000;
+    __disable_irq();
+    uint32_t frames = s_frames, underflows = s_underflows, bmErrors = s_bmErrors, late = s_lateFrames;
+    s_frames = s_underflows = s_bmErrors = s_lateFrames = 0;
+    __enable_irq();
+    Serial.printf("fps: %u, underflows: %u, bm errors: %u, late frames: %u\n", frames, underflows, bmErrors, late);
+  }
 }
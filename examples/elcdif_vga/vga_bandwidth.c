@@ -0,0 +1,47 @@
+#include <math.h>
+#include <sdram_timing.h>
+#include "vga_bandwidth.h"
+
+static float ns_to_clocks(float ns, float freq)
+{
+  float clocks = ceilf(ns * 1.0e-9f * freq);
+  return clocks < 1.0f ? 1.0f : clocks;
+}
+
+// fraction of the raw bus rate left after command overhead for sequential access
+static float sdram_efficiency(float freq)
+{
+  // each burst waits out the CAS latency, each row is opened and precharged once
+  const float bursts_per_row = SDRAM_ROW_BYTES / (SDRAM_BURST_WORDS * SDRAM_BUS_BYTES);
+  float cas = freq > SDRAM_CAS2_MAX ? 3 : 2;
+  float row_clocks = bursts_per_row * (SDRAM_BURST_WORDS + cas) + ns_to_clocks(SDRAM_TRCD_NS, freq) + ns_to_clocks(SDRAM_TRP_NS, freq);
+  float refresh = SDRAM_REFRESH_COUNT * ns_to_clocks(SDRAM_TRFC_NS, freq) / (SDRAM_REFRESH_MS * 1e-3f * freq);
+  return bursts_per_row * SDRAM_BURST_WORDS / row_clocks * (1.0f - refresh);
+}
+
+bool vga_bandwidth_plan(const vga_timing* vid, unsigned int bpp, float semc_freq, float cpu_reserve, vga_bandwidth* bw)
+{
+  const uint32_t htotal = vid->width + vid->hfp + vid->hsw + vid->hbp;
+  const uint32_t vtotal = vid->height + vid->vfp + vid->vsw + vid->vbp;
+
+  *bw = (vga_bandwidth){0};
+  if (vid->clk_den == 0 || htotal == 0 || vtotal == 0 || bpp == 0)
+    return false;
+
+  bw->pix_clk = 24e6f * vid->clk_num / vid->clk_den;
+  bw->refresh = bw->pix_clk / ((float)htotal * vtotal);
+  bw->scanout_peak = bw->pix_clk * bpp;
+  bw->scanout_avg = (float)vid->width * vid->height * bpp * bw->refresh;
+
+  // extmem_freq() returns -1 if there is no extmem, 0 if it is unknown
+  if (semc_freq <= 0.0f)
+    return false;
+
+  bw->semc_peak = semc_freq * SDRAM_BUS_BYTES;
+  bw->semc_usable = bw->semc_peak * sdram_efficiency(semc_freq);
+  bw->cpu_headroom = bw->semc_usable - bw->scanout_avg;
+  bw->load = bw->scanout_avg / bw->semc_usable;
+  // averages against averages; the peak only has to fit on its own while a line is fetched
+  bw->fits = cpu_reserve <= bw->cpu_headroom && bw->scanout_peak <= bw->semc_usable;
+  return true;
+}
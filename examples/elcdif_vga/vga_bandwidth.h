@@ -0,0 +1,99 @@
+#ifndef _VGA_BANDWIDTH_H_
+#define _VGA_BANDWIDTH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// polarity bits from imxrt.h, so the timing table can also be built off-target
+#ifndef LCDIF_VDCTRL0_VSYNC_POL
+#define LCDIF_VDCTRL0_VSYNC_POL ((uint32_t)(1<<27))
+#endif
+#ifndef LCDIF_VDCTRL0_HSYNC_POL
+#define LCDIF_VDCTRL0_HSYNC_POL ((uint32_t)(1<<26))
+#endif
+
+typedef struct {
+  uint32_t height;
+  uint32_t vfp; // vertical front porch
+  uint32_t vsw; // vertical sync width
+  uint32_t vbp; // vertical back porch
+  uint32_t width;
+  uint32_t hfp; // horizontal front porch
+  uint32_t hsw; // horizontal sync width
+  uint32_t hbp; // horizontal back porch
+  // clk_num * 24MHz / clk_den = pixel clock
+  uint32_t clk_num; // pix_clk numerator
+  uint32_t clk_den; // pix_clk denominator
+  uint32_t vpolarity; // 0 (active low vsync/negative) or LCDIF_VDCTRL0_VSYNC_POL (active high/positive)
+  uint32_t hpolarity; // 0 (active low hsync/negative) or LCDIF_VDCTRL0_HSYNC_POL (active high/positive)
+} vga_timing;
+
+static const vga_timing t1920x1080x60 = {1080, 4, 5, 36, 1920, 88, 44, 148, 297, 48, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
+// as above but with half clock speed
+static const vga_timing t1920x1080x30 = {1080, 4, 5, 36, 1920, 88, 44, 148, 297, 96, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
+static const vga_timing t1680x1050x60 = {1050, 1, 3, 33, 1680, 104, 184, 288, 6125, 999, LCDIF_VDCTRL0_VSYNC_POL, 0};
+static const vga_timing t1280x1024x60 = {1024, 1, 3, 38, 1280, 48, 112, 248, 108, 24, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
+static const vga_timing t1280x720x60 = {720, 13, 5, 12, 1280, 80, 40, 248, 7425, 2400, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
+static const vga_timing t1024x768x60 = {768, 3, 6, 29, 1024, 24, 136, 160, 65, 24, 0, 0};
+
+static const vga_timing t800x600x100 =  {600, 1, 3, 32, 800, 48, 88, 136, 6818, 2400, LCDIF_VDCTRL0_VSYNC_POL, 0};
+static const vga_timing t800x600x60 =   {600, 1, 4, 23, 800, 40, 128, 88, 40, 24, LCDIF_VDCTRL0_VSYNC_POL, LCDIF_VDCTRL0_HSYNC_POL};
+static const vga_timing t640x480x60 =   {480, 10, 2, 33, 640, 16, 96, 48, 150, 143, 0, 0};
+static const vga_timing t640x400x70 =   {400, 12, 2, 35, 640, 16, 96, 48, 150, 143, LCDIF_VDCTRL0_VSYNC_POL, 0};
+static const vga_timing t640x350x70 =   {350, 37, 2, 60, 640, 16, 96, 48, 150, 143, 0, LCDIF_VDCTRL0_HSYNC_POL};
+
+// every mode above, for walking the whole table (e.g. from a host-side check)
+static const struct {
+  const char* name;
+  const vga_timing* timing;
+} vga_timing_table[] = {
+  {"1920x1080x60", &t1920x1080x60},
+  {"1920x1080x30", &t1920x1080x30},
+  {"1680x1050x60", &t1680x1050x60},
+  {"1280x1024x60", &t1280x1024x60},
+  {"1280x720x60", &t1280x720x60},
+  {"1024x768x60", &t1024x768x60},
+  {"800x600x100", &t800x600x100},
+  {"800x600x60", &t800x600x60},
+  {"640x480x60", &t640x480x60},
+  {"640x400x70", &t640x400x70},
+  {"640x350x70", &t640x350x70},
+};
+
+/* Scanout bandwidth budget for a mode, all rates in bytes/sec.
+ * The LCDIF only fetches during the active part of each line, so while a line
+ * is being scanned out it needs pix_clk*bpp; averaged over the whole frame
+ * (including blanking) it needs width*height*refresh*bpp.
+ * Scanout reads the framebuffer sequentially, so semc_usable assumes every burst
+ * waits out the CAS latency and each SDRAM row is opened (tRCD) and precharged (tRP)
+ * once, plus the time lost to auto-refresh. Timings come from sdram_timing.h.
+ */
+typedef struct {
+  float pix_clk;       // pixel clock (Hz)
+  float refresh;       // frame rate (Hz)
+  float semc_peak;     // raw SEMC data rate: 16-bit bus, one transfer per clock
+  float semc_usable;   // semc_peak derated for SDRAM command overhead
+  float scanout_peak;  // demand during the active part of a line
+  float scanout_avg;   // demand averaged over the whole frame
+  float cpu_headroom;  // semc_usable - scanout_avg, what is left for the CPU (may be negative)
+  float load;          // scanout_avg / semc_usable (0.0 - 1.0+)
+  bool fits;           // cpu_reserve <= cpu_headroom and scanout_peak <= semc_usable
+} vga_bandwidth;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fill in *bw for the given mode. bpp is bytes per pixel in the framebuffer,
+ * semc_freq is the value returned by extmem_freq() (Hz), cpu_reserve is the SDRAM
+ * traffic (bytes/sec) the CPU needs while the display is running.
+ * Returns false if the timing or frequency is invalid (e.g. no SDRAM present).
+ */
+bool vga_bandwidth_plan(const vga_timing* vid, unsigned int bpp, float semc_freq, float cpu_reserve, vga_bandwidth* bw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
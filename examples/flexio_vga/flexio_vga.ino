@@ -454,13 +454,15 @@ PROGMEM static const vga_timing t640x350x70 = {
 typedef uint8_t frameBuffer_t[(MAX_HEIGHT+1)*(MAX_WIDTH+STRIDE_PADDING)];
 
 static uint8_t* s_frameBuffer[2];
+// reserve space for one framebuffer at the top of SDRAM (weak symbol in SDRAM.c)
+size_t sdram_fb_size = sizeof(frameBuffer_t);
 
 const vga_timing *timing = &t640x400x70;
 FlexIO2VGA FLEXIOVGA(*timing);
 
 void setup() {
   Serial.begin(115200);
-  s_frameBuffer[0] = (uint8_t*)extmem_base;
+  s_frameBuffer[0] = (uint8_t*)sdram_fb_alloc(sizeof(frameBuffer_t));
   s_frameBuffer[1] = (uint8_t*)malloc(sizeof(frameBuffer_t));
 
   if (s_frameBuffer[0] == NULL || s_frameBuffer[1] == NULL)
@@ -0,0 +1,54 @@
+#include <SDRAM.h>
+
+/* Splits SDRAM three ways: 8MB for the newlib heap (malloc/new), 2MB reserved for
+ * framebuffers and the rest for extmem_malloc(). These override the weak defaults in SDRAM.c.
+ */
+size_t sdram_heap_size = 8 << 20;
+size_t sdram_fb_size = 2 << 20;
+
+// move the newlib heap into SDRAM
+extern "C" void* _sbrk(int incr) { return sdram_sbrk(incr); }
+
+static void print_region(const char* name, const sdram_region* r) {
+  Serial.printf("%-12s %p - %p: %8u used, %8u high water, %8u size\n",
+    name, r->base, r->base + r->size, r->used, r->high_water, r->size);
+}
+
+static void print_regions(void) {
+  print_region("newlib heap", &sdram_heap_region);
+  print_region("extmem pool", &sdram_pool_region);
+  print_region("framebuffer", &sdram_fb_region);
+}
+
+void setup() {
+  Serial.begin(0);
+  while (!Serial);
+
+  if (!sdram_split_ok) {
+    Serial.println("SDRAM not found or the requested split doesn't fit, malloc is using RAM2");
+  }
+  print_regions();
+
+  // general purpose allocations come from the newlib heap
+  uint32_t* a = new uint32_t[256 * 1024];
+  void* b = malloc(1 << 20);
+  // explicit extmem allocations come from the pool
+  void* c = extmem_malloc(3 << 20);
+  void* d = extmem_calloc(1000, 100);
+  // framebuffers are carved out of their own region and never freed
+  void* fb = sdram_fb_alloc(640 * 480);
+  Serial.printf("\nnew: %p, malloc: %p, extmem_malloc: %p, extmem_calloc: %p, fb: %p\n", a, b, c, d, fb);
+  print_regions();
+
+  delete[] a;
+  free(b);
+  extmem_free(c);
+  Serial.println("\nAfter freeing (heap keeps its break, pool usage drops, high water stays):");
+  print_regions();
+
+  extmem_free(d);
+  Serial.printf("\nExact pool usage: %u\n", sdram_pool_stats());
+}
+
+void loop() {
+}
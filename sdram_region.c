@@ -0,0 +1,101 @@
+#include "sdram_region.h"
+
+#define ALIGN_UP(x,a) (((x) + ((a)-1)) & ~((size_t)(a)-1))
+
+static void update_high_water(sdram_region* r)
+{
+	if (r->used > r->high_water)
+		r->high_water = r->used;
+}
+
+// round *x up to SDRAM_REGION_ALIGN, fails instead of wrapping around
+static bool align_up(size_t* x)
+{
+	if (*x > SIZE_MAX - (SDRAM_REGION_ALIGN-1))
+		return false;
+	*x = ALIGN_UP(*x, SDRAM_REGION_ALIGN);
+	return true;
+}
+
+void sdram_region_init(sdram_region* r, void* base, size_t size)
+{
+	r->base = (char*)base;
+	r->size = size;
+	r->used = 0;
+	r->high_water = 0;
+}
+
+bool sdram_region_split(void* base, size_t total, size_t heap_size, size_t fb_size,
+	sdram_region* heap, sdram_region* pool, sdram_region* fb)
+{
+	char* start = (char*)base;
+
+	// check each term separately so the sum can't overflow
+	if (!align_up(&heap_size) || !align_up(&fb_size) || heap_size > total || fb_size > total - heap_size)
+	{
+		sdram_region_init(heap, start, 0);
+		sdram_region_init(pool, start, total);
+		sdram_region_init(fb, start + total, 0);
+		return false;
+	}
+
+	sdram_region_init(heap, start, heap_size);
+	sdram_region_init(pool, start + heap_size, total - heap_size - fb_size);
+	sdram_region_init(fb, start + total - fb_size, fb_size);
+	return true;
+}
+
+void* sdram_region_sbrk(sdram_region* r, ptrdiff_t incr)
+{
+	char* prev = r->base + r->used;
+
+	if (incr < 0)
+	{
+		// negate in the unsigned domain, -PTRDIFF_MIN overflows
+		size_t dec = (size_t)0 - (size_t)incr;
+		if (dec > r->used)
+			return NULL;
+		r->used -= dec;
+	}
+	else
+	{
+		if ((size_t)incr > r->size - r->used)
+			return NULL;
+		r->used += incr;
+		update_high_water(r);
+	}
+	return prev;
+}
+
+void* sdram_region_alloc(sdram_region* r, size_t size, size_t align)
+{
+	uintptr_t top = (uintptr_t)(r->base + r->used);
+	size_t pad = ALIGN_UP(top, align) - top;
+
+	if (pad > r->size - r->used || size > r->size - r->used - pad)
+		return NULL;
+
+	r->used += pad + size;
+	update_high_water(r);
+	return (void*)(top + pad);
+}
+
+void sdram_region_set_used(sdram_region* r, size_t used)
+{
+	r->used = used;
+	update_high_water(r);
+}
+
+void sdram_region_account(sdram_region* r, ptrdiff_t delta)
+{
+	if (delta < 0)
+	{
+		size_t dec = (size_t)0 - (size_t)delta;
+		r->used = dec > r->used ? 0 : r->used - dec;
+	}
+	else
+	{
+		r->used += delta;
+		update_high_water(r);
+	}
+}
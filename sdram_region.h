@@ -0,0 +1,51 @@
+#ifndef _SDRAM_REGION_H_
+#define _SDRAM_REGION_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Bookkeeping for one slice of SDRAM. This file has no hardware dependencies
+ * so the layout and accounting can be exercised on a host machine.
+ */
+typedef struct {
+	char* base;
+	size_t size;
+	size_t used;       // bytes currently in use
+	size_t high_water; // largest value "used" has reached
+} sdram_region;
+
+// region boundaries are rounded to this (LCDIF framebuffers need 64-byte alignment)
+#define SDRAM_REGION_ALIGN 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void sdram_region_init(sdram_region* r, void* base, size_t size);
+
+/* Divide [base, base+total) into the newlib heap (bottom), the smalloc pool
+ * (middle) and the framebuffer region (top). heap_size and fb_size are rounded
+ * up to SDRAM_REGION_ALIGN, the pool gets whatever is left.
+ * Returns false if the requested sizes don't fit; the whole range is then given
+ * to the pool and the other two regions are left empty.
+ */
+bool sdram_region_split(void* base, size_t total, size_t heap_size, size_t fb_size,
+	sdram_region* heap, sdram_region* pool, sdram_region* fb);
+
+// move the break of a region by incr bytes, returns the old break or NULL if it would leave the region
+void* sdram_region_sbrk(sdram_region* r, ptrdiff_t incr);
+
+// bump allocate size bytes aligned to align (a power of two), returns NULL if there isn't room
+void* sdram_region_alloc(sdram_region* r, size_t size, size_t align);
+
+// adjust usage for allocations managed elsewhere, clamped at zero
+void sdram_region_account(sdram_region* r, ptrdiff_t delta);
+// set usage measured elsewhere (e.g. from smalloc stats)
+void sdram_region_set_used(sdram_region* r, size_t used);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
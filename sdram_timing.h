@@ -0,0 +1,29 @@
+#ifndef _SDRAM_TIMING_H_
+#define _SDRAM_TIMING_H_
+
+/* Timings for the SDRAM fitted to Teensy 4.1 boards: IS42S16160J-6 (32MB / 166MHz / CL3).
+ * Used by SDRAM.c to program the SEMC and by anything that models its bandwidth.
+ * No hardware dependencies, so this can also be included off-target.
+ */
+
+// CAS latency 3 will be used if frequency is above this, else use CL=2
+#define SDRAM_CAS2_MAX 1665e5f
+
+#define SDRAM_TRAS_NS 42 // ACTIVE to PRECHARGE
+#define SDRAM_TWR_NS  12 // WRITE recovery
+#define SDRAM_TRFC_NS 60 // REFRESH recovery
+#define SDRAM_TRCD_NS 18 // ACTIVE to READ/WRITE
+#define SDRAM_TRP_NS  18 // PRECHARGE to ACTIVE/REFRESH
+#define SDRAM_TRC_NS  60 // ACTIVE to ACTIVE
+#define SDRAM_TXSR_NS 66 // self refresh recovery
+
+// 8192 auto-refreshes every 64ms
+#define SDRAM_REFRESH_COUNT 8192
+#define SDRAM_REFRESH_MS    64
+
+#define SDRAM_BUS_BYTES   2   // 16-bit data bus
+#define SDRAM_BURST_WORDS 8   // SEMC_SDRAMCR0_BL(3)
+#define SDRAM_COLUMNS     512 // SEMC_SDRAMCR0_COL(3) = 9 bit column
+#define SDRAM_ROW_BYTES   (SDRAM_COLUMNS * SDRAM_BUS_BYTES)
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _CHECK_H_
+#define _CHECK_H_
+
+/* Minimal helpers for the host-side tests in this folder. Build and run each test
+ * from here with the sources it exercises, e.g.
+ *   gcc -Wall -Wextra -I.. sdram_region_test.c ../sdram_region.c -o sdram_region_test && ./sdram_region_test
+ * This folder isn't compiled by the Arduino IDE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+static int check_failures;
+
+#define CHECK(cond) do { \
+	if (!(cond)) { \
+		printf("FAIL %s: %s (line %d)\n", __func__, #cond, __LINE__); \
+		check_failures++; \
+	} \
+} while (0)
+
+// for floats computed by hand: |actual - expected| <= tol
+#define CHECK_NEAR(actual, expected, tol) CHECK(fabs((double)(actual) - (double)(expected)) <= (tol))
+
+static int check_report(void)
+{
+	printf("%s\n", check_failures ? "FAILED" : "all tests passed");
+	return check_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,161 @@
+/* Host-side tests for the SDRAM region bookkeeping (sdram_region.c).
+ *   gcc -Wall -Wextra -I.. sdram_region_test.c ../sdram_region.c -o sdram_region_test && ./sdram_region_test
+ */
+#include <stdint.h>
+#include "check.h"
+#include "sdram_region.h"
+
+#define TOTAL (1<<20)
+
+static char mem[TOTAL] __attribute__((aligned(SDRAM_REGION_ALIGN)));
+
+static void check_all_pool(sdram_region* heap, sdram_region* pool, sdram_region* fb)
+{
+	CHECK(heap->base == mem && heap->size == 0);
+	CHECK(pool->base == mem && pool->size == TOTAL);
+	CHECK(fb->base == mem + TOTAL && fb->size == 0);
+}
+
+static void test_split(void)
+{
+	sdram_region heap, pool, fb;
+
+	CHECK(sdram_region_split(mem, TOTAL, 1000, 4000, &heap, &pool, &fb));
+	// sizes rounded up to the region alignment
+	CHECK(heap.size == 1024 && fb.size == 4032);
+	// contiguous, bottom to top: heap, pool, framebuffers
+	CHECK(heap.base == mem);
+	CHECK(pool.base == heap.base + heap.size);
+	CHECK(fb.base == pool.base + pool.size);
+	CHECK(fb.base + fb.size == mem + TOTAL);
+	CHECK((size_t)pool.base % SDRAM_REGION_ALIGN == 0 && (size_t)fb.base % SDRAM_REGION_ALIGN == 0);
+	CHECK(heap.used == 0 && pool.used == 0 && fb.used == 0);
+
+	// default: everything goes to the pool
+	CHECK(sdram_region_split(mem, TOTAL, 0, 0, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+
+	// exactly full is allowed
+	CHECK(sdram_region_split(mem, TOTAL, TOTAL/2, TOTAL/2, &heap, &pool, &fb));
+	CHECK(pool.size == 0 && pool.base == mem + TOTAL/2);
+}
+
+static void test_split_invalid(void)
+{
+	sdram_region heap, pool, fb;
+
+	CHECK(!sdram_region_split(mem, TOTAL, TOTAL+1, 0, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+	CHECK(!sdram_region_split(mem, TOTAL, 0, TOTAL+1, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+	CHECK(!sdram_region_split(mem, TOTAL, TOTAL/2, TOTAL/2+1, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+	// rounding up would push these past the end
+	CHECK(!sdram_region_split(mem, TOTAL, TOTAL-1, 1, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+	// would wrap around to 0 when rounded or summed
+	CHECK(!sdram_region_split(mem, TOTAL, (size_t)-1, 0, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+	CHECK(!sdram_region_split(mem, TOTAL, 0, (size_t)-1, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+	CHECK(!sdram_region_split(mem, TOTAL, (size_t)-64, 128, &heap, &pool, &fb));
+	check_all_pool(&heap, &pool, &fb);
+}
+
+static void test_sbrk(void)
+{
+	sdram_region r;
+	sdram_region_init(&r, mem, 1024);
+
+	CHECK(sdram_region_sbrk(&r, 0) == mem);
+	CHECK(sdram_region_sbrk(&r, 600) == mem);
+	CHECK(sdram_region_sbrk(&r, 600) == NULL);
+	CHECK(r.used == 600);
+	CHECK(sdram_region_sbrk(&r, 424) == mem + 600);
+	CHECK(r.used == 1024);
+	CHECK(sdram_region_sbrk(&r, 1) == NULL);
+	// shrinking returns the old break
+	CHECK(sdram_region_sbrk(&r, -224) == mem + 1024);
+	CHECK(r.used == 800 && r.high_water == 1024);
+	CHECK(sdram_region_sbrk(&r, -801) == NULL);
+	CHECK(r.used == 800);
+	CHECK(sdram_region_sbrk(&r, -800) == mem + 800);
+	CHECK(r.used == 0 && r.high_water == 1024);
+
+	// empty region
+	sdram_region_init(&r, mem, 0);
+	CHECK(sdram_region_sbrk(&r, 1) == NULL);
+	CHECK(sdram_region_sbrk(&r, -1) == NULL);
+
+	// most negative increment must not overflow when negated
+	sdram_region_init(&r, mem, 1024);
+	CHECK(sdram_region_sbrk(&r, 100) == mem);
+	CHECK(sdram_region_sbrk(&r, PTRDIFF_MIN) == NULL);
+	CHECK(sdram_region_sbrk(&r, PTRDIFF_MAX) == NULL);
+	CHECK(r.used == 100);
+}
+
+static void test_alloc(void)
+{
+	sdram_region r;
+	sdram_region_init(&r, mem, 256);
+
+	char* a = sdram_region_alloc(&r, 10, 64);
+	char* b = sdram_region_alloc(&r, 10, 64);
+	CHECK(a == mem && b == mem + 64);
+	CHECK(r.used == 74);
+	// smaller alignment packs tighter
+	char* c = sdram_region_alloc(&r, 1, 4);
+	CHECK(c == mem + 76 && r.used == 77);
+	// padding up to the next 64-byte boundary (128) leaves only 128 bytes
+	CHECK(sdram_region_alloc(&r, 129, 64) == NULL);
+	CHECK(sdram_region_alloc(&r, 128, 64) == mem + 128);
+	CHECK(r.used == 256 && r.high_water == 256);
+	CHECK(sdram_region_alloc(&r, 0, 1) == mem + 256);
+	CHECK(sdram_region_alloc(&r, 1, 1) == NULL);
+
+	// base not aligned: padding is counted as used
+	sdram_region_init(&r, mem + 8, 128);
+	CHECK(sdram_region_alloc(&r, 8, 64) == mem + 64);
+	CHECK(r.used == 64);
+	// padding alone doesn't fit
+	sdram_region_init(&r, mem + 8, 32);
+	CHECK(sdram_region_alloc(&r, 0, 64) == NULL);
+	CHECK(r.used == 0);
+}
+
+static void test_account(void)
+{
+	sdram_region r;
+	sdram_region_init(&r, mem, TOTAL);
+
+	sdram_region_account(&r, 500);
+	sdram_region_account(&r, -300);
+	CHECK(r.used == 200 && r.high_water == 500);
+	sdram_region_account(&r, 700);
+	CHECK(r.used == 900 && r.high_water == 900);
+	// freeing more than is in use clamps at zero
+	sdram_region_account(&r, -1000);
+	CHECK(r.used == 0 && r.high_water == 900);
+	sdram_region_account(&r, 100);
+	sdram_region_account(&r, PTRDIFF_MIN);
+	CHECK(r.used == 0 && r.high_water == 900);
+
+	sdram_region_set_used(&r, 400);
+	CHECK(r.used == 400 && r.high_water == 900);
+	sdram_region_set_used(&r, 1200);
+	CHECK(r.used == 1200 && r.high_water == 1200);
+	sdram_region_set_used(&r, 0);
+	CHECK(r.used == 0 && r.high_water == 1200);
+}
+
+int main(void)
+{
+	test_split();
+	test_split_invalid();
+	test_sbrk();
+	test_alloc();
+	test_account();
+
+	return check_report();
+}
@@ -0,0 +1,91 @@
+/* Host-side tests for vga_bandwidth_plan() (examples/elcdif_vga/vga_bandwidth.c).
+ *   gcc -Wall -Wextra -I.. -I../examples/elcdif_vga vga_bandwidth_test.c ../examples/elcdif_vga/vga_bandwidth.c -lm -o vga_bandwidth_test && ./vga_bandwidth_test
+ */
+#include "check.h"
+#include "vga_bandwidth.h"
+
+// every mode in the table, at the SEMC clock elcdif_vga uses (SEMC_CLOCK_CPU_DIV_3)
+static void test_timing_table(void)
+{
+	vga_bandwidth bw, bw2;
+
+	for (size_t i=0; i < sizeof(vga_timing_table)/sizeof(vga_timing_table[0]); i++) {
+		const char* name = vga_timing_table[i].name;
+		const vga_timing* vid = vga_timing_table[i].timing;
+
+		// nominal resolution and refresh are in the name, e.g. 1920x1080x60
+		unsigned int w, h, hz;
+		CHECK(sscanf(name, "%ux%ux%u", &w, &h, &hz) == 3);
+		CHECK(w == vid->width && h == vid->height);
+
+		CHECK(vga_bandwidth_plan(vid, 1, 200e6f, 0, &bw));
+		printf("%-14s %6.2fHz pix_clk %7.2fMHz scanout %6.1f peak %6.1f avg, usable %6.1f, headroom %6.1f MB/s\n",
+			name, bw.refresh, bw.pix_clk / 1e6f, bw.scanout_peak / 1e6f, bw.scanout_avg / 1e6f,
+			bw.semc_usable / 1e6f, bw.cpu_headroom / 1e6f);
+
+		CHECK_NEAR(bw.refresh, hz, 0.5);
+		CHECK(bw.scanout_peak >= bw.scanout_avg);
+		// every mode fits with an idle CPU and with a full redraw every frame
+		CHECK(bw.fits);
+		CHECK(vga_bandwidth_plan(vid, 1, 200e6f, bw.scanout_avg, &bw2) && bw2.fits);
+		// doubling bpp doubles the demand
+		CHECK(vga_bandwidth_plan(vid, 2, 200e6f, 0, &bw2));
+		CHECK_NEAR(bw2.scanout_avg, 2*bw.scanout_avg, 1.0);
+		// asking for more than the headroom never fits
+		CHECK(vga_bandwidth_plan(vid, 1, 200e6f, bw.cpu_headroom * 1.01f, &bw2) && !bw2.fits);
+	}
+}
+
+/* 1920x1080x60, worked out by hand.
+ * 200MHz: CL3, tRCD = tRP = 4 clocks, tRFC = 12 clocks. A 1KB row is 64 bursts of 8 words:
+ *   64*(8+3) + 4 + 4 = 712 clocks for 512 words, refresh costs 8192*12 clocks per 64ms
+ *   usable = 400MB/s * 512/712 * (1 - 98304/12.8e6) = 285.431MB/s
+ * 133MHz: CL2, tRCD = tRP = 3 clocks, tRFC = 8 clocks
+ *   usable = 266MB/s * 512/646 * (1 - 65536/8.512e6) = 209.203MB/s
+ * scanout: 148.5MHz pix_clk, 1920*1080*60 = 124.416MB/s average
+ */
+static void test_1080p60(void)
+{
+	vga_bandwidth bw;
+
+	CHECK(vga_bandwidth_plan(&t1920x1080x60, 1, 200e6f, 0, &bw));
+	CHECK_NEAR(bw.pix_clk, 148.5e6, 1e3);
+	CHECK_NEAR(bw.refresh, 60.0, 1e-3);
+	CHECK_NEAR(bw.scanout_peak, 148.5e6, 1e3);
+	CHECK_NEAR(bw.scanout_avg, 124.416e6, 1e3);
+	CHECK_NEAR(bw.semc_usable, 285.431e6, 0.05e6);
+	CHECK_NEAR(bw.cpu_headroom, 161.015e6, 0.05e6);
+	CHECK_NEAR(bw.load, 124.416 / 285.431, 1e-3);
+
+	// elcdif_vga's default: full redraw every frame at 200MHz fits...
+	CHECK(vga_bandwidth_plan(&t1920x1080x60, 1, 200e6f, 124.416e6f, &bw) && bw.fits);
+	// ...but not at 133MHz, even though scanout alone does
+	CHECK(vga_bandwidth_plan(&t1920x1080x60, 1, 133e6f, 0, &bw) && bw.fits);
+	CHECK_NEAR(bw.semc_usable, 209.203e6, 0.05e6);
+	CHECK(vga_bandwidth_plan(&t1920x1080x60, 1, 133e6f, 124.416e6f, &bw) && !bw.fits);
+
+	// 16bpp: 297MB/s while a line is fetched, more than the bus can deliver at 200MHz
+	CHECK(vga_bandwidth_plan(&t1920x1080x60, 2, 200e6f, 0, &bw) && !bw.fits);
+}
+
+static void test_invalid(void)
+{
+	vga_bandwidth bw;
+
+	// extmem_freq() returns -1 without extmem and 0 if unknown
+	CHECK(!vga_bandwidth_plan(&t640x480x60, 1, -1.0f, 0, &bw));
+	CHECK(!vga_bandwidth_plan(&t640x480x60, 1, 0.0f, 0, &bw));
+
+	vga_timing bad = t640x480x60;
+	bad.clk_den = 0;
+	CHECK(!vga_bandwidth_plan(&bad, 1, 200e6f, 0, &bw));
+	CHECK(!vga_bandwidth_plan(&t640x480x60, 0, 200e6f, 0, &bw));
+}
+
+int main(void)
+{
+	test_timing_table();
+	test_1080p60();
+	test_invalid();
+	return check_report();
+}